@@ -3,6 +3,7 @@
 #define AEQUALIS_DIFFMODEL_HPP
 #include "Aequalis/Types.hpp"
 #include <QAbstractTableModel>
+#include <QVector>
 #include <vector>
 
 namespace aequalis {
@@ -16,9 +17,16 @@ public:
   QVariant data(const QModelIndex& index, int role) const override;
   QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
 
+  // Rows are kept in relpath order; already-sorted input is taken as is.
   void setDiffs(std::vector<DiffItem> diffs);
+  // Replace rows with matching relpaths in place: all rows are applied first,
+  // then dataChanged per contiguous run and a single rowsPatched (no reset).
+  void patchDiffs(const std::vector<DiffItem>& updated);
   const std::vector<DiffItem>& diffs() const { return m_diffs; }
 
+signals:
+  void rowsPatched(const QVector<int>& rows); // ascending
+
 private:
   std::vector<DiffItem> m_diffs;
 };
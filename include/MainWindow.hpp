@@ -2,13 +2,16 @@
 #ifndef AEQUALIS_MAINWINDOW_HPP
 #define AEQUALIS_MAINWINDOW_HPP
 #include <QMainWindow>
+#include <QPointer>
 #include <QSet>
 
 QT_BEGIN_NAMESPACE
-class QLineEdit; class QPushButton; class QRadioButton; class QLabel; class QTreeView; class QFileSystemModel; class QTableView; class QCheckBox; class QProgressBar; class QMenu;
+class QLineEdit; class QPushButton; class QRadioButton; class QLabel; class QTreeView; class QTableView; class QCheckBox; class QProgressBar; class QMenu; class QAction;
 QT_END_NAMESPACE
 
 #include "Aequalis/DiffModel.hpp"
+#include "Aequalis/PathTreeModel.hpp"
+#include "Aequalis/Worker.hpp"
 
 namespace aequalis {
 
@@ -23,8 +26,14 @@ private slots:
   void doCompare();
   void onCompared(std::vector<DiffItem> diffs);
   void onCompareFailed(QString err);
+  void onCompareCancelled();
   void doUpdate();
+  void doSyncNow();
+  void onSynced(std::vector<DiffItem> diffs, int copied, QStringList errors);
+  void onSyncCancelled(int copied, QStringList errors);
   void showAbout();
+  void cancelWork();
+  void updateModeOptions();
 
   // worker progress
   void onPhase(const QString& phase);
@@ -35,6 +44,7 @@ private:
   void buildUi();
   void buildMenus();
   QSet<QString> currentIgnores() const;
+  void setBusy(bool busy);
 
   QString m_home;
   QWidget* m_central{nullptr};
@@ -46,15 +56,24 @@ private:
   QPushButton* m_dstBtn{nullptr};
   QPushButton* m_compareBtn{nullptr};
   QPushButton* m_updateBtn{nullptr};
+  QPushButton* m_syncBtn{nullptr};
+  QPushButton* m_cancelBtn{nullptr};
+  QAction* m_actCompare{nullptr};
+  QAction* m_actSync{nullptr};
+  bool m_busy{false};
   QLabel* m_status{nullptr};
   QProgressBar* m_prog{nullptr};
   QTreeView* m_srcView{nullptr};
   QTreeView* m_dstView{nullptr};
-  QFileSystemModel* m_srcModel{nullptr};
-  QFileSystemModel* m_dstModel{nullptr};
+  PathTreeModel* m_srcModel{nullptr};
+  PathTreeModel* m_dstModel{nullptr};
   QTableView* m_table{nullptr};
   DiffModel* m_model{nullptr};
   QCheckBox* m_cbSkipHeavy{nullptr};
+  QCheckBox* m_cbContent{nullptr};
+  QCheckBox* m_cbRanges{nullptr};
+  QPointer<CompareWorker> m_compareWorker;
+  QPointer<SyncWorker> m_syncWorker;
 };
 
 } // namespace aequalis
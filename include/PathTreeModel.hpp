@@ -0,0 +1,78 @@
+#ifndef AEQUALIS_PATHTREEMODEL_HPP
+#define AEQUALIS_PATHTREEMODEL_HPP
+#include "Aequalis/Types.hpp"
+#include <QAbstractItemModel>
+#include <QSet>
+#include <QVector>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace aequalis {
+
+class DiffModel;
+
+// One side of the last compare shown as a directory tree. Built from the
+// DiffModel's (relpath-sorted) rows; directory children are only materialised
+// when the view expands them (canFetchMore/fetchMore). Patched DiffModel rows
+// are applied in place: files appearing or vanishing on this side are
+// inserted/removed and directory colours follow per-action counts, so the
+// view never resets or collapses for a small update.
+class PathTreeModel : public QAbstractItemModel {
+  Q_OBJECT
+public:
+  enum class Side { Source, Destination };
+
+  PathTreeModel(Side side, const DiffModel* diffs, QObject* parent=nullptr);
+
+  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+  QModelIndex parent(const QModelIndex& child) const override;
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+  bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+  bool canFetchMore(const QModelIndex& parent) const override;
+  void fetchMore(const QModelIndex& parent) override;
+
+private:
+  static constexpr int ACTION_KINDS = 7;
+  using Counts = std::array<int, ACTION_KINDS>; // rows on this side, by action rank
+
+  struct Node {
+    Node* parent{nullptr};
+    int row{0};
+    QString name;
+    int begin{0}, end{0};              // DiffModel rows under this prefix, on either side
+    int prefixLen{0};                  // length of the "dir/sub/" prefix shared by the range
+    int item{-1};                      // DiffModel row for files, -1 for directories
+    Counts counts{};                   // directories only
+    Action action{Action::Identical};  // most significant action in the subtree
+    bool fetched{false};
+    std::vector<std::unique_ptr<Node>> children;
+  };
+
+  struct RowState {
+    bool exists{false};
+    Action action{Action::Identical};
+  };
+
+  void rebuild();
+  void onRowsPatched(const QVector<int>& rows);
+  void applyRow(int row, QSet<Node*>& dirty);
+  std::vector<std::unique_ptr<Node>> makeChildren(Node* n) const;
+  Node* insertChild(Node* n, int row);
+  void removeNode(Node* n, QSet<Node*>& dirty);
+  QModelIndex indexOf(Node* n) const;
+  Node* nodeFor(const QModelIndex& idx) const;
+  const FileMeta& metaOf(const DiffItem& d) const;
+
+  Side m_side;
+  const DiffModel* m_diffs;
+  std::vector<RowState> m_state; // per DiffModel row, as currently shown
+  std::unique_ptr<Node> m_root;
+};
+
+} // namespace aequalis
+
+#endif // AEQUALIS_PATHTREEMODEL_HPP
@@ -6,31 +6,75 @@
 #include <QSet>
 #include <QHash>
 #include <QStringList>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
 namespace aequalis {
 
 using CancelFn = std::function<bool()>;
+using ProgressFn = std::function<void(std::uint64_t done, std::uint64_t total)>; // bytes
 using MetaMap = QHash<QString, FileMeta>; // relpath -> meta
+using VisitFn = std::function<void(const QString& relpath, const FileMeta& meta)>;
+
+struct ContentDiff {
+  bool ok{false};              // both files were read to the end
+  bool identical{false};
+  std::uint64_t firstDiff{0};  // byte offset of the first mismatch
+  std::uint64_t ranges{0};     // maximal runs of differing bytes (at most 1 unless counted)
+  QString error;
+};
+
+// Visit regular files under root as they are found; ignores names set.
+void walkFiles(const QString& root,
+               const QSet<QString>& ignoreNames,
+               const VisitFn& visit,
+               const CancelFn& cancel = {});
+
+// Relpaths of regular files under root, without stat'ing them.
+QStringList listFiles(const QString& root,
+                      const QSet<QString>& ignoreNames = {},
+                      const CancelFn& cancel = {});
 
 // Collect regular files under root quickly; ignores names set.
 MetaMap fastListFiles(const QString& root,
                       const QSet<QString>& ignoreNames = {},
                       const CancelFn& cancel = {});
 
+FileMeta statPath(const QString& path);
+
+// Apply the sync policy to one pair of metas.
+DiffItem classify(const QString& relpath, const FileMeta& src, const FileMeta& dst);
+
 DiffItem compareFiles(const QString& src, const QString& dst);
 
+// Byte-exact comparison of two regular files. Both are walked in large mapped
+// windows (buffered reads if mapping fails); equal blocks are skipped with memcmp
+// and range boundaries are found a word at a time. Stops at the first mismatch
+// unless countRanges asks for every differing range (reads both files in full).
+ContentDiff compareContents(const QString& src, const QString& dst,
+                            bool countRanges = false,
+                            const CancelFn& cancel = {},
+                            const ProgressFn& progress = {});
+
 std::vector<DiffItem> compareDirs(const QString& srcRoot,
                                   const QString& dstRoot,
                                   const QSet<QString>& ignoreNames = {},
                                   const CancelFn& cancel = {});
 
+// Copy one relpath (creating parents, keeping the source mtime); error set on failure.
+bool copyItem(const QString& srcRoot,
+              const QString& dstRoot,
+              const QString& relpath,
+              QString& error);
+
+// Copy eligible items; touched receives each copied relpath with its new destination meta.
 bool copyItems(const QString& srcRoot,
                const QString& dstRoot,
                const std::vector<DiffItem>& diffs,
                int& copied,
                QStringList& errors,
+               MetaMap& touched,
                const CancelFn& cancel = {});
 
 } // namespace aequalis
@@ -32,8 +32,12 @@ struct DiffItem {
   QString reason;
   FileMeta src;
   FileMeta dst;
+  QString dstName; // Files mode: destination file name when it differs from relpath
 };
 
+// Canonical result order: by relpath, so every directory's entries are contiguous.
+inline bool relpathLess(const DiffItem& a, const DiffItem& b) { return a.relpath < b.relpath; }
+
 } // namespace aequalis
 
 #endif // AEQUALIS_TYPES_HPP
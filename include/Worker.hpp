@@ -4,10 +4,14 @@
 #include "Aequalis/Types.hpp"
 #include <QThread>
 #include <QSet>
+#include <QStringList>
 #include <atomic>
 
 namespace aequalis {
 
+// Files-mode content check on top of the size/mtime heuristic.
+enum class ContentCheck { Off, FirstDiff, AllRanges };
+
 class CompareWorker : public QThread {
   Q_OBJECT
 public:
@@ -15,11 +19,13 @@ public:
                 QString src,
                 QString dst,
                 QSet<QString> ignores,
+                ContentCheck content,
                 QObject* parent=nullptr);
   void cancel();
 
 signals:
   void done(std::vector<DiffItem> diffs);
+  void cancelled();
   void failed(QString error);
   void phase(QString label);
   void progressRange(int min, int max);
@@ -30,6 +36,35 @@ protected:
 
 private:
   bool m_filesMode{false};
+  ContentCheck m_content{ContentCheck::Off};
+  QString m_src, m_dst;
+  QSet<QString> m_ignores;
+  std::atomic_bool m_cancel{false};
+};
+
+// Unattended compare-and-sync: CopyNew/CopyNewer items are handed to a small
+// copy pool through a bounded queue while the source tree is still being walked.
+class SyncWorker : public QThread {
+  Q_OBJECT
+public:
+  SyncWorker(QString src,
+             QString dst,
+             QSet<QString> ignores,
+             QObject* parent=nullptr);
+  void cancel();
+
+signals:
+  void done(std::vector<DiffItem> diffs, int copied, QStringList errors);
+  void cancelled(int copied, QStringList errors); // copies finished before the stop
+  void failed(QString error);
+  void phase(QString label);
+  void progressRange(int min, int max);
+  void progressValue(int value);
+
+protected:
+  void run() override;
+
+private:
   QString m_src, m_dst;
   QSet<QString> m_ignores;
   std::atomic_bool m_cancel{false};
@@ -1,6 +1,7 @@
 
 #include "Aequalis/DiffModel.hpp"
 #include <QDateTime>
+#include <algorithm>
 
 namespace aequalis {
 
@@ -52,9 +53,32 @@ QVariant DiffModel::headerData(int section, Qt::Orientation orientation, int rol
 }
 
 void DiffModel::setDiffs(std::vector<DiffItem> diffs) {
+  if (!std::is_sorted(diffs.begin(), diffs.end(), relpathLess))
+    std::sort(diffs.begin(), diffs.end(), relpathLess);
   beginResetModel();
   m_diffs = std::move(diffs);
   endResetModel();
 }
 
+void DiffModel::patchDiffs(const std::vector<DiffItem>& updated) {
+  QVector<int> rows;
+  rows.reserve(static_cast<int>(updated.size()));
+  for (const auto& u : updated) {
+    auto it = std::lower_bound(m_diffs.begin(), m_diffs.end(), u, relpathLess);
+    if (it == m_diffs.end() || it->relpath != u.relpath) continue;
+    *it = u;
+    rows.push_back(static_cast<int>(it - m_diffs.begin()));
+  }
+  if (rows.isEmpty()) return;
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  for (int i = 0; i < rows.size();) {
+    int j = i + 1;
+    while (j < rows.size() && rows[j] == rows[j - 1] + 1) ++j;
+    emit dataChanged(index(rows[i], 0), index(rows[j - 1], columnCount() - 1));
+    i = j;
+  }
+  emit rowsPatched(rows);
+}
+
 } // namespace aequalis
@@ -11,7 +11,6 @@
 #include <QGroupBox>
 #include <QTableView>
 #include <QHeaderView>
-#include <QFileSystemModel>
 #include <QCheckBox>
 #include <QLabel>
 #include <QPushButton>
@@ -39,8 +38,10 @@ void MainWindow::buildMenus() {
   connect(actQuit, &QAction::triggered, this, &QWidget::close);
 
   auto* toolMenu = menuBar()->addMenu("&Tool");
-  auto* actCompare = toolMenu->addAction("Compare");
-  connect(actCompare, &QAction::triggered, this, &MainWindow::doCompare);
+  m_actCompare = toolMenu->addAction("Compare");
+  connect(m_actCompare, &QAction::triggered, this, &MainWindow::doCompare);
+  m_actSync = toolMenu->addAction("Sync Now");
+  connect(m_actSync, &QAction::triggered, this, &MainWindow::doSyncNow);
 
   auto* helpMenu = menuBar()->addMenu("&Help");
   auto* actAbout = helpMenu->addAction("About");
@@ -57,6 +58,12 @@ void MainWindow::buildUi() {
   m_cbSkipHeavy = new QCheckBox("Skip VCS/build folders (.git, node_modules, build, dist, __pycache__)");
   m_cbSkipHeavy->setChecked(true);
 
+  m_cbContent = new QCheckBox("Byte-exact content check (Files mode)");
+  m_cbRanges  = new QCheckBox("Count every differing range (reads both files in full)");
+  connect(m_rbFiles, &QRadioButton::toggled, this, &MainWindow::updateModeOptions);
+  connect(m_cbContent, &QCheckBox::toggled, this, &MainWindow::updateModeOptions);
+  updateModeOptions();
+
   m_srcEdit = new QLineEdit(m_home);
   m_dstEdit = new QLineEdit(m_home);
   m_srcBtn = new QPushButton("Browse…");
@@ -65,24 +72,31 @@ void MainWindow::buildUi() {
   connect(m_srcBtn, &QPushButton::clicked, this, &MainWindow::pickSource);
   connect(m_dstBtn, &QPushButton::clicked, this, &MainWindow::pickDestination);
 
-  m_srcModel = new QFileSystemModel(this); m_srcModel->setRootPath(m_home);
-  m_dstModel = new QFileSystemModel(this); m_dstModel->setRootPath(m_home);
-  m_srcView = new QTreeView; m_srcView->setModel(m_srcModel); m_srcView->setRootIndex(m_srcModel->index(m_home));
-  m_dstView = new QTreeView; m_dstView->setModel(m_dstModel); m_dstView->setRootIndex(m_dstModel->index(m_home));
-  for (auto* v : {m_srcView, m_dstView}) { v->setAlternatingRowColors(true); v->setSortingEnabled(true); }
+  // Panes mirror the last compare's results (coloured by action) instead of watching the filesystem.
+  m_model = new DiffModel(this);
+  m_srcModel = new PathTreeModel(PathTreeModel::Side::Source, m_model, this);
+  m_dstModel = new PathTreeModel(PathTreeModel::Side::Destination, m_model, this);
+  m_srcView = new QTreeView; m_srcView->setModel(m_srcModel);
+  m_dstView = new QTreeView; m_dstView->setModel(m_dstModel);
+  for (auto* v : {m_srcView, m_dstView}) { v->setAlternatingRowColors(true); v->setUniformRowHeights(true); }
 
   auto* splitter = new QSplitter(Qt::Horizontal);
   auto* g1 = new QGroupBox("Source"); auto* l1 = new QVBoxLayout(g1); l1->addWidget(m_srcView);
   auto* g2 = new QGroupBox("Destination"); auto* l2 = new QVBoxLayout(g2); l2->addWidget(m_dstView);
   splitter->addWidget(g1); splitter->addWidget(g2);
 
-  m_model = new DiffModel(this);
   m_table = new QTableView; m_table->setModel(m_model); m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
   m_compareBtn = new QPushButton("Compare");
   m_updateBtn  = new QPushButton("Update Destination");
+  m_syncBtn    = new QPushButton("Sync Now");
+  m_syncBtn->setToolTip("Compare and copy new/newer files in one pass, without review");
   connect(m_compareBtn, &QPushButton::clicked, this, &MainWindow::doCompare);
   connect(m_updateBtn,  &QPushButton::clicked, this, &MainWindow::doUpdate);
+  connect(m_syncBtn,    &QPushButton::clicked, this, &MainWindow::doSyncNow);
+  m_cancelBtn  = new QPushButton("Cancel");
+  m_cancelBtn->setEnabled(false);
+  connect(m_cancelBtn,  &QPushButton::clicked, this, &MainWindow::cancelWork);
 
   auto* form = new QGridLayout; int row = 0;
   auto* modeBox = new QWidget; auto* modeL = new QHBoxLayout(modeBox); modeL->setContentsMargins(0,0,0,0);
@@ -95,6 +109,8 @@ void MainWindow::buildUi() {
   addRow("Source", m_srcEdit, m_srcBtn);
   addRow("Destination", m_dstEdit, m_dstBtn);
   form->addWidget(m_cbSkipHeavy, row++, 1);
+  form->addWidget(m_cbContent, row++, 1);
+  form->addWidget(m_cbRanges, row++, 1);
 
   auto* center = new QWidget; setCentralWidget(center);
   auto* root = new QVBoxLayout(center);
@@ -102,7 +118,7 @@ void MainWindow::buildUi() {
   root->addWidget(splitter);
   root->addWidget(new QLabel("Assessment:"));
   root->addWidget(m_table);
-  auto* ctl = new QHBoxLayout; ctl->addStretch(1); ctl->addWidget(m_compareBtn); ctl->addWidget(m_updateBtn);
+  auto* ctl = new QHBoxLayout; ctl->addStretch(1); ctl->addWidget(m_compareBtn); ctl->addWidget(m_updateBtn); ctl->addWidget(m_syncBtn); ctl->addWidget(m_cancelBtn);
   root->addLayout(ctl);
 
   // Status bar with message + progress bar on the right
@@ -113,6 +129,26 @@ void MainWindow::buildUi() {
   statusBar()->addPermanentWidget(m_prog);
 }
 
+// One worker at a time: every entry point that starts work is disabled while busy.
+void MainWindow::setBusy(bool busy) {
+  m_busy = busy;
+  m_compareBtn->setEnabled(!busy); m_updateBtn->setEnabled(!busy); m_syncBtn->setEnabled(!busy);
+  m_actCompare->setEnabled(!busy); m_actSync->setEnabled(!busy);
+  m_cancelBtn->setEnabled(busy);
+}
+
+void MainWindow::cancelWork() {
+  if (m_compareWorker) m_compareWorker->cancel();
+  if (m_syncWorker) m_syncWorker->cancel();
+}
+
+// Content options only apply to Files mode; range counting only with the content check.
+void MainWindow::updateModeOptions() {
+  const bool files = m_rbFiles->isChecked();
+  m_cbContent->setEnabled(files);
+  m_cbRanges->setEnabled(files && m_cbContent->isChecked());
+}
+
 QSet<QString> MainWindow::currentIgnores() const {
   if (!m_cbSkipHeavy->isChecked()) return {};
   return QSet<QString>{".git", ".hg", ".svn", ".idea", ".vscode", "node_modules", "__pycache__", "dist", "build"};
@@ -133,16 +169,22 @@ void MainWindow::pickDestination() {
 }
 
 void MainWindow::doCompare() {
+  if (m_busy) return;
   const auto s = m_srcEdit->text().trimmed();
   const auto d = m_dstEdit->text().trimmed();
   if (s.isEmpty() || d.isEmpty()) { QMessageBox::warning(this, "Missing Paths", "Select both Source and Destination"); return; }
 
   m_status->setText("Scanning…");
   m_prog->setRange(0,0); // indeterminate during scan
-  m_compareBtn->setEnabled(false); m_updateBtn->setEnabled(false);
+  setBusy(true);
 
-  auto* w = new CompareWorker(m_rbFiles->isChecked(), s, d, currentIgnores(), this);
+  ContentCheck content = ContentCheck::Off;
+  if (m_rbFiles->isChecked() && m_cbContent->isChecked())
+    content = m_cbRanges->isChecked() ? ContentCheck::AllRanges : ContentCheck::FirstDiff;
+  auto* w = new CompareWorker(m_rbFiles->isChecked(), s, d, currentIgnores(), content, this);
+  m_compareWorker = w;
   connect(w, &CompareWorker::done, this, &MainWindow::onCompared);
+  connect(w, &CompareWorker::cancelled, this, &MainWindow::onCompareCancelled);
   connect(w, &CompareWorker::failed, this, &MainWindow::onCompareFailed);
   connect(w, &CompareWorker::phase,  this, &MainWindow::onPhase);
   connect(w, &CompareWorker::progressRange, this, &MainWindow::onProgressRange);
@@ -151,6 +193,54 @@ void MainWindow::doCompare() {
   w->start();
 }
 
+void MainWindow::doSyncNow() {
+  if (m_busy) return;
+  const auto s = m_srcEdit->text().trimmed();
+  const auto d = m_dstEdit->text().trimmed();
+  if (s.isEmpty() || d.isEmpty()) { QMessageBox::warning(this, "Missing Paths", "Select both Source and Destination"); return; }
+  if (m_rbFiles->isChecked()) { QMessageBox::information(this, "Folders only", "Sync Now works in Folders mode."); return; }
+  if (QMessageBox::question(this, "Confirm Sync",
+        "Copy every new or newer source file into the destination without review?\n"
+        "Destination-newer and ambiguous files are left untouched.") != QMessageBox::Yes) return;
+
+  m_status->setText("Syncing…");
+  m_prog->setRange(0,0);
+  setBusy(true);
+
+  auto* w = new SyncWorker(s, d, currentIgnores(), this);
+  m_syncWorker = w;
+  connect(w, &SyncWorker::done, this, &MainWindow::onSynced);
+  connect(w, &SyncWorker::cancelled, this, &MainWindow::onSyncCancelled);
+  connect(w, &SyncWorker::failed, this, &MainWindow::onCompareFailed);
+  connect(w, &SyncWorker::phase,  this, &MainWindow::onPhase);
+  connect(w, &SyncWorker::progressRange, this, &MainWindow::onProgressRange);
+  connect(w, &SyncWorker::progressValue, this, &MainWindow::onProgressValue);
+  connect(w, &QThread::finished, w, &QObject::deleteLater);
+  w->start();
+}
+
+void MainWindow::onSynced(std::vector<DiffItem> diffs, int copied, QStringList errors) {
+  m_model->setDiffs(std::move(diffs));
+  m_status->setText(QString("Synced %1 — copied:%2 errors:%3").arg(m_model->diffs().size()).arg(copied).arg(errors.size()));
+  m_prog->setRange(0,1); m_prog->setValue(0); // idle
+  if (!errors.isEmpty()) {
+    QMessageBox::warning(this, "Sync completed with errors", QString("Copied %1; errors %2\n").arg(copied).arg(errors.size()) + errors.join("\n"));
+  } else {
+    QMessageBox::information(this, "Sync complete", QString("Copied %1 items.").arg(copied));
+  }
+  setBusy(false);
+}
+
+// The previous assessment stays; copies already made are not reflected in it.
+void MainWindow::onSyncCancelled(int copied, QStringList errors) {
+  m_status->setText(QString("Sync cancelled — copied:%1 errors:%2").arg(copied).arg(errors.size()));
+  m_prog->setRange(0,1); m_prog->setValue(0); // idle
+  QString msg = QString("Copied %1 item(s) before cancelling. Run Compare to refresh the assessment.").arg(copied);
+  if (!errors.isEmpty()) msg += QString("\n\nErrors %1:\n").arg(errors.size()) + errors.join("\n");
+  QMessageBox::information(this, "Sync cancelled", msg);
+  setBusy(false);
+}
+
 void MainWindow::onPhase(const QString& phase) {
   m_status->setText(phase);
 }
@@ -164,44 +254,65 @@ void MainWindow::onProgressValue(int val) {
   m_prog->setValue(val);
 }
 
-void MainWindow::onCompared(std::vector<DiffItem> diffs) {
-  m_model->setDiffs(std::move(diffs));
-  const auto& v = m_model->diffs();
-  int copies=0,newer=0,onlyd=0,ident=0,typem=0;
+namespace {
+struct Tally { int copies=0, newer=0, onlyd=0, ident=0, typem=0; };
+}
+
+static Tally tally(const std::vector<DiffItem>& v) {
+  Tally t;
   for (const auto& d : v) {
     switch (d.action) {
-      case Action::CopyNew: case Action::CopyNewer: case Action::CopyMismatch: ++copies; break;
-      case Action::SkipDestNewer: ++newer; break;
-      case Action::OnlyInDest: ++onlyd; break;
-      case Action::Identical: ++ident; break;
-      case Action::TypeMismatch: ++typem; break;
+      case Action::CopyNew: case Action::CopyNewer: case Action::CopyMismatch: ++t.copies; break;
+      case Action::SkipDestNewer: ++t.newer; break;
+      case Action::OnlyInDest: ++t.onlyd; break;
+      case Action::Identical: ++t.ident; break;
+      case Action::TypeMismatch: ++t.typem; break;
     }
   }
-  m_status->setText(QString("Compared %1 — copy:%2 newer-dst:%3 only-dst:%4 identical:%5 type-m:%6")
-                    .arg(v.size()).arg(copies).arg(newer).arg(onlyd).arg(ident).arg(typem));
+  return t;
+}
+
+static QString tallyLine(const QString& verb, size_t items, const Tally& t) {
+  return QString("%1 %2 — copy:%3 newer-dst:%4 only-dst:%5 identical:%6 type-m:%7")
+           .arg(verb).arg(items).arg(t.copies).arg(t.newer).arg(t.onlyd).arg(t.ident).arg(t.typem);
+}
+
+void MainWindow::onCompared(std::vector<DiffItem> diffs) {
+  m_model->setDiffs(std::move(diffs));
+  const auto& v = m_model->diffs();
+  const Tally t = tally(v);
+  m_status->setText(tallyLine("Compared", v.size(), t));
   m_prog->setRange(0,1); m_prog->setValue(0); // idle
   QMessageBox::information(this, "Assessment complete",
     QString("Compared %1 items.\\n\\n")
       .arg(v.size()) +
-    QString("Will COPY: %1\\n").arg(copies) +
-    QString("Destination NEWER (skipped): %1\\n").arg(newer) +
-    QString("Only in Destination: %1\\n").arg(onlyd) +
-    QString("Identical: %1").arg(ident)
+    QString("Will COPY: %1\\n").arg(t.copies) +
+    QString("Destination NEWER (skipped): %1\\n").arg(t.newer) +
+    QString("Only in Destination: %1\\n").arg(t.onlyd) +
+    QString("Identical: %1").arg(t.ident)
   );
-  m_compareBtn->setEnabled(true); m_updateBtn->setEnabled(true);
+  setBusy(false);
 }
 
 void MainWindow::onCompareFailed(QString err) {
   m_status->setText("Error");
   m_prog->setRange(0,1); m_prog->setValue(0);
   QMessageBox::critical(this, "Compare Error", err);
-  m_compareBtn->setEnabled(true); m_updateBtn->setEnabled(true);
+  setBusy(false);
+}
+
+// The previous assessment (if any) stays in place.
+void MainWindow::onCompareCancelled() {
+  m_status->setText("Cancelled");
+  m_prog->setRange(0,1); m_prog->setValue(0);
+  setBusy(false);
 }
 
 void MainWindow::doUpdate() {
+  if (m_busy) return;
   const auto s = m_srcEdit->text().trimmed();
   const auto d = m_dstEdit->text().trimmed();
-  const auto diffs = m_model->diffs();
+  const auto& diffs = m_model->diffs();
   int copies=0; QStringList errors;
   if (diffs.empty()) { QMessageBox::information(this, "Nothing to do", "Run Compare first."); return; }
   for (const auto& di : diffs) {
@@ -209,13 +320,21 @@ void MainWindow::doUpdate() {
   }
   if (copies==0) { QMessageBox::information(this, "Up-to-date", "No eligible items to copy."); return; }
   if (QMessageBox::question(this, "Confirm Update", QString("Copy %1 item(s)?").arg(copies)) != QMessageBox::Yes) return;
-  int copied = 0;
-  copyItems(s, d, diffs, copied, errors);
+  int copied = 0; MetaMap touched;
+  copyItems(s, d, diffs, copied, errors, touched);
+
+  // Re-verify only what was written: re-stat the source side, take the fresh
+  // destination meta from the copy, and patch those rows in place.
+  std::vector<DiffItem> updated; updated.reserve(static_cast<size_t>(touched.size()));
+  for (auto it = touched.constBegin(); it != touched.constEnd(); ++it)
+    updated.push_back(classify(it.key(), statPath(s + "/" + it.key()), it.value()));
+  m_model->patchDiffs(updated);
+  m_status->setText(tallyLine("Updated", m_model->diffs().size(), tally(m_model->diffs())));
+
   if (!errors.isEmpty()) {
     QMessageBox::warning(this, "Completed with errors", QString("Copied %1; errors %2\\n").arg(copied).arg(errors.size()) + errors.join("\\n"));
   } else {
     QMessageBox::information(this, "Update complete", QString("Copied %1 items.").arg(copied));
-    doCompare();
   }
 }
 
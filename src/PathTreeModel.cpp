@@ -0,0 +1,290 @@
+#include "Aequalis/PathTreeModel.hpp"
+#include "Aequalis/DiffModel.hpp"
+#include <QColor>
+#include <QDateTime>
+#include <QSet>
+#include <algorithm>
+
+namespace aequalis {
+
+// Action ranks in ascending significance; a directory shows its highest non-empty rank.
+static const Action RANKED[] = {
+  Action::Identical, Action::SkipDestNewer, Action::OnlyInDest, Action::CopyNewer,
+  Action::CopyNew, Action::CopyMismatch, Action::TypeMismatch
+};
+
+static int actionRank(Action a) {
+  switch (a) {
+    case Action::Identical: return 0;
+    case Action::SkipDestNewer: return 1;
+    case Action::OnlyInDest: return 2;
+    case Action::CopyNewer: return 3;
+    case Action::CopyNew: return 4;
+    case Action::CopyMismatch: return 5;
+    case Action::TypeMismatch: return 6;
+  }
+  return 0;
+}
+
+template <typename Counts>
+static Action summarize(const Counts& c) {
+  for (int r = static_cast<int>(c.size()) - 1; r > 0; --r)
+    if (c[static_cast<size_t>(r)] > 0) return RANKED[r];
+  return Action::Identical;
+}
+
+template <typename Counts>
+static int total(const Counts& c) {
+  int n = 0;
+  for (int k : c) n += k;
+  return n;
+}
+
+static QVariant actionColor(Action a) {
+  switch (a) {
+    case Action::Identical: return {};
+    case Action::CopyNew: return QColor(0x2e, 0x7d, 0x32);
+    case Action::CopyNewer: return QColor(0x15, 0x65, 0xc0);
+    case Action::CopyMismatch: return QColor(0xef, 0x6c, 0x00);
+    case Action::SkipDestNewer: return QColor(0x6a, 0x1b, 0x9a);
+    case Action::OnlyInDest: return QColor(0xc6, 0x28, 0x28);
+    case Action::TypeMismatch: return QColor(0x8e, 0x00, 0x00);
+  }
+  return {};
+}
+
+PathTreeModel::PathTreeModel(Side side, const DiffModel* diffs, QObject* parent)
+  : QAbstractItemModel(parent), m_side(side), m_diffs(diffs) {
+  connect(m_diffs, &QAbstractItemModel::modelReset, this, &PathTreeModel::rebuild);
+  connect(m_diffs, &DiffModel::rowsPatched, this, &PathTreeModel::onRowsPatched);
+  rebuild();
+}
+
+const FileMeta& PathTreeModel::metaOf(const DiffItem& d) const {
+  return m_side == Side::Source ? d.src : d.dst;
+}
+
+void PathTreeModel::rebuild() {
+  beginResetModel();
+  const auto& v = m_diffs->diffs();
+  m_state.assign(v.size(), RowState{});
+  m_root = std::make_unique<Node>();
+  for (size_t i = 0; i < v.size(); ++i) {
+    m_state[i] = RowState{metaOf(v[i]).exists, v[i].action};
+    if (m_state[i].exists) ++m_root->counts[static_cast<size_t>(actionRank(v[i].action))];
+  }
+  m_root->end = static_cast<int>(v.size());
+  m_root->action = summarize(m_root->counts);
+  m_root->children = makeChildren(m_root.get());
+  m_root->fetched = true;
+  endResetModel();
+}
+
+// Group n's range by the next path component. Rows are relpath-sorted, so each
+// directory's entries are contiguous; entries absent on this side are skipped.
+std::vector<std::unique_ptr<PathTreeModel::Node>> PathTreeModel::makeChildren(Node* n) const {
+  std::vector<std::unique_ptr<Node>> out;
+  const auto& v = m_diffs->diffs();
+  int i = n->begin;
+  while (i < n->end) {
+    const DiffItem& first = v[static_cast<size_t>(i)];
+    const int slash = first.relpath.indexOf('/', n->prefixLen);
+    auto c = std::make_unique<Node>();
+    c->parent = n;
+    c->row = static_cast<int>(out.size());
+    c->begin = i;
+    if (slash < 0) {
+      const RowState st = m_state[static_cast<size_t>(i)];
+      c->name = first.relpath.mid(n->prefixLen);
+      c->item = i;
+      c->action = st.action;
+      c->fetched = true;
+      c->end = ++i;
+      if (st.exists) out.push_back(std::move(c));
+      continue;
+    }
+    c->name = first.relpath.mid(n->prefixLen, slash - n->prefixLen);
+    c->prefixLen = slash + 1;
+    const QString dirPrefix = first.relpath.left(c->prefixLen);
+    for (; i < n->end && v[static_cast<size_t>(i)].relpath.startsWith(dirPrefix); ++i) {
+      const RowState st = m_state[static_cast<size_t>(i)];
+      if (st.exists) ++c->counts[static_cast<size_t>(actionRank(st.action))];
+    }
+    c->end = i;
+    c->action = summarize(c->counts);
+    if (total(c->counts) > 0) out.push_back(std::move(c));
+  }
+  return out;
+}
+
+QModelIndex PathTreeModel::indexOf(Node* n) const {
+  return n == m_root.get() ? QModelIndex() : createIndex(n->row, 0, n);
+}
+
+// Add the child of fetched directory n that leads to row. A new directory starts
+// empty and fetched: its other rows are absent on this side, so it fills up as
+// the batch reaches them.
+PathTreeModel::Node* PathTreeModel::insertChild(Node* n, int row) {
+  const auto& v = m_diffs->diffs();
+  const QString& rel = v[static_cast<size_t>(row)].relpath;
+  const int slash = rel.indexOf('/', n->prefixLen);
+  auto c = std::make_unique<Node>();
+  c->parent = n;
+  c->fetched = true;
+  if (slash < 0) {
+    c->name = rel.mid(n->prefixLen);
+    c->item = row;
+    c->begin = row;
+    c->end = row + 1;
+  } else {
+    c->name = rel.mid(n->prefixLen, slash - n->prefixLen);
+    c->prefixLen = slash + 1;
+    const QString dirPrefix = rel.left(c->prefixLen);
+    const auto first = v.begin() + n->begin, last = v.begin() + n->end;
+    const auto lo = std::lower_bound(first, last, dirPrefix,
+                                     [](const DiffItem& d, const QString& k){ return d.relpath < k; });
+    const auto hi = std::partition_point(lo, last, [&](const DiffItem& d){ return d.relpath.startsWith(dirPrefix); });
+    c->begin = static_cast<int>(lo - v.begin());
+    c->end = static_cast<int>(hi - v.begin());
+  }
+  const auto pos = std::upper_bound(n->children.begin(), n->children.end(), c->begin,
+                                    [](int b, const std::unique_ptr<Node>& k){ return b < k->begin; }) - n->children.begin();
+  Node* raw = c.get();
+  beginInsertRows(indexOf(n), static_cast<int>(pos), static_cast<int>(pos));
+  n->children.insert(n->children.begin() + pos, std::move(c));
+  for (size_t k = static_cast<size_t>(pos); k < n->children.size(); ++k) n->children[k]->row = static_cast<int>(k);
+  endInsertRows();
+  return raw;
+}
+
+void PathTreeModel::removeNode(Node* n, QSet<Node*>& dirty) {
+  Node* p = n->parent;
+  const int r = n->row;
+  beginRemoveRows(indexOf(p), r, r);
+  dirty.remove(n);
+  p->children.erase(p->children.begin() + r);
+  for (size_t k = static_cast<size_t>(r); k < p->children.size(); ++k) p->children[k]->row = static_cast<int>(k);
+  endRemoveRows();
+}
+
+// Move one row from its shown state to the DiffModel's: adjust counts down the
+// fetched path, add the missing nodes, then prune anything left empty.
+void PathTreeModel::applyRow(int row, QSet<Node*>& dirty) {
+  const DiffItem& d = m_diffs->diffs()[static_cast<size_t>(row)];
+  const RowState was = m_state[static_cast<size_t>(row)];
+  const RowState now{metaOf(d).exists, d.action};
+  m_state[static_cast<size_t>(row)] = now;
+  if (!was.exists && !now.exists) return;
+
+  std::vector<Node*> path;
+  Node* n = m_root.get();
+  for (;;) {
+    path.push_back(n);
+    if (n->item >= 0) { n->action = now.action; break; }
+    if (was.exists) --n->counts[static_cast<size_t>(actionRank(was.action))];
+    if (now.exists) ++n->counts[static_cast<size_t>(actionRank(now.action))];
+    n->action = summarize(n->counts);
+    if (!n->fetched) break;
+    const auto c = std::upper_bound(n->children.begin(), n->children.end(), row,
+                                    [](int r, const std::unique_ptr<Node>& k){ return r < k->begin; });
+    Node* next = (c != n->children.begin() && row < (*std::prev(c))->end) ? std::prev(c)->get() : nullptr;
+    if (!next) {
+      if (!now.exists) break;
+      next = insertChild(n, row);
+    }
+    n = next;
+  }
+
+  size_t keep = path.size();
+  while (keep > 1) {
+    Node* p = path[keep - 1];
+    const bool gone = p->item >= 0 ? !now.exists : total(p->counts) == 0;
+    if (!gone) break;
+    removeNode(p, dirty);
+    --keep;
+  }
+  for (size_t k = 1; k < keep; ++k) dirty.insert(path[k]);
+}
+
+void PathTreeModel::onRowsPatched(const QVector<int>& rows) {
+  QSet<Node*> dirty;
+  for (int row : rows) applyRow(row, dirty);
+  for (Node* n : dirty)
+    emit dataChanged(createIndex(n->row, 0, n), createIndex(n->row, columnCount() - 1, n));
+}
+
+PathTreeModel::Node* PathTreeModel::nodeFor(const QModelIndex& idx) const {
+  return idx.isValid() ? static_cast<Node*>(idx.internalPointer()) : m_root.get();
+}
+
+QModelIndex PathTreeModel::index(int row, int column, const QModelIndex& parent) const {
+  if (!hasIndex(row, column, parent)) return {};
+  return createIndex(row, column, nodeFor(parent)->children[static_cast<size_t>(row)].get());
+}
+
+QModelIndex PathTreeModel::parent(const QModelIndex& child) const {
+  if (!child.isValid()) return {};
+  Node* p = nodeFor(child)->parent;
+  if (!p || p == m_root.get()) return {};
+  return createIndex(p->row, 0, p);
+}
+
+int PathTreeModel::rowCount(const QModelIndex& parent) const {
+  if (parent.column() > 0) return 0;
+  return static_cast<int>(nodeFor(parent)->children.size());
+}
+
+int PathTreeModel::columnCount(const QModelIndex&) const { return 3; }
+
+bool PathTreeModel::hasChildren(const QModelIndex& parent) const {
+  const Node* n = nodeFor(parent);
+  return n->item < 0 && total(n->counts) > 0;
+}
+
+bool PathTreeModel::canFetchMore(const QModelIndex& parent) const {
+  const Node* n = nodeFor(parent);
+  return n->item < 0 && !n->fetched;
+}
+
+void PathTreeModel::fetchMore(const QModelIndex& parent) {
+  Node* n = nodeFor(parent);
+  if (n->item >= 0 || n->fetched) return;
+  auto kids = makeChildren(n);
+  n->fetched = true;
+  if (kids.empty()) return;
+  beginInsertRows(parent, 0, static_cast<int>(kids.size()) - 1);
+  n->children = std::move(kids);
+  endInsertRows();
+}
+
+QVariant PathTreeModel::data(const QModelIndex& idx, int role) const {
+  if (!idx.isValid()) return {};
+  const Node* n = nodeFor(idx);
+  if (role == Qt::ForegroundRole) return actionColor(n->action);
+  if (n->item < 0) {
+    if (role == Qt::DisplayRole && idx.column() == 0) return n->name;
+    return {};
+  }
+  const auto& d = m_diffs->diffs()[static_cast<size_t>(n->item)];
+  const auto& m = metaOf(d);
+  if (role == Qt::DisplayRole) {
+    switch (idx.column()) {
+      case 0: return (m_side == Side::Destination && !d.dstName.isEmpty()) ? d.dstName : n->name;
+      case 1: return QVariant::fromValue<qlonglong>(static_cast<qlonglong>(m.size));
+      case 2: return QDateTime::fromSecsSinceEpoch(static_cast<qint64>(m.mtime)).toString("yyyy-MM-dd HH:mm:ss");
+    }
+  }
+  if (role == Qt::ToolTipRole) return d.reason;
+  if (role == Qt::TextAlignmentRole && idx.column() == 1) return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+  return {};
+}
+
+QVariant PathTreeModel::headerData(int section, Qt::Orientation orientation, int role) const {
+  if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return {};
+  switch (section) {
+    case 0: return "Name"; case 1: return "Size"; case 2: return "Modified";
+  }
+  return {};
+}
+
+} // namespace aequalis
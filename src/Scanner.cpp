@@ -6,10 +6,16 @@
 #include <QSaveFile>
 #include <QDateTime>
 #include <QtConcurrent>
+#include <algorithm>
 #include <filesystem>
 #include <system_error>
 #include <chrono>
 #include <cmath>
+#include <cstring>
+#ifdef AEQ_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -38,11 +44,12 @@ static FileMeta metaFromPath(const fs::path& p) {
   return fm;
 }
 
-MetaMap fastListFiles(const QString& root, const QSet<QString>& ignoreNames, const CancelFn& cancel) {
-  MetaMap out;
+// Shared traversal; visit gets each regular file's path and relpath, no stat.
+static void walkTree(const QString& root, const QSet<QString>& ignoreNames,
+                     const std::function<void(const fs::path&, const QString&)>& visit, const CancelFn& cancel) {
   fs::path rootp = fs::u8path(root.toStdString());
   std::error_code ec;
-  if (!fs::exists(rootp, ec) || !fs::is_directory(rootp, ec)) return out;
+  if (!fs::exists(rootp, ec) || !fs::is_directory(rootp, ec)) return;
 
   std::vector<fs::path> stack{rootp};
   while (!stack.empty()) {
@@ -59,19 +66,34 @@ MetaMap fastListFiles(const QString& root, const QSet<QString>& ignoreNames, con
         stack.emplace_back(p);
       } else if (it->is_regular_file(ec2)) {
         auto rel = QString::fromStdString(fs::relative(p, rootp, ec2).u8string());
-        out.insert(rel, metaFromPath(p));
+        visit(p, rel);
       }
     }
   }
+}
+
+void walkFiles(const QString& root, const QSet<QString>& ignoreNames, const VisitFn& visit, const CancelFn& cancel) {
+  walkTree(root, ignoreNames, [&](const fs::path& p, const QString& rel){ visit(rel, metaFromPath(p)); }, cancel);
+}
+
+QStringList listFiles(const QString& root, const QSet<QString>& ignoreNames, const CancelFn& cancel) {
+  QStringList out;
+  walkTree(root, ignoreNames, [&](const fs::path&, const QString& rel){ out << rel; }, cancel);
   return out;
 }
 
-DiffItem compareFiles(const QString& src, const QString& dst) {
-  fs::path sp = fs::u8path(src.toStdString());
-  fs::path dp = fs::u8path(dst.toStdString());
-  FileMeta s = metaFromPath(sp);
-  FileMeta d = metaFromPath(dp);
-  DiffItem di{QString::fromStdString(sp.filename().u8string()), Action::Identical, QString(), s, d};
+MetaMap fastListFiles(const QString& root, const QSet<QString>& ignoreNames, const CancelFn& cancel) {
+  MetaMap out;
+  walkFiles(root, ignoreNames, [&](const QString& rel, const FileMeta& m){ out.insert(rel, m); }, cancel);
+  return out;
+}
+
+FileMeta statPath(const QString& path) {
+  return metaFromPath(fs::u8path(path.toStdString()));
+}
+
+DiffItem classify(const QString& relpath, const FileMeta& s, const FileMeta& d) {
+  DiffItem di{relpath, Action::Identical, QString(), s, d};
 
   if (!s.exists && !d.exists) { di.reason = "Both missing"; return di; }
   if (s.exists && !d.exists) { di.action = Action::CopyNew; di.reason = "Missing in destination"; return di; }
@@ -83,6 +105,166 @@ DiffItem compareFiles(const QString& src, const QString& dst) {
   di.action = Action::CopyMismatch; di.reason = "Ambiguous difference"; return di;
 }
 
+DiffItem compareFiles(const QString& src, const QString& dst) {
+  fs::path sp = fs::u8path(src.toStdString());
+  fs::path dp = fs::u8path(dst.toStdString());
+  auto di = classify(QString::fromStdString(sp.filename().u8string()), metaFromPath(sp), metaFromPath(dp));
+  const auto dstName = QString::fromStdString(dp.filename().u8string());
+  if (dstName != di.relpath) di.dstName = dstName;
+  return di;
+}
+
+static constexpr qint64 CMP_WINDOW = 64 * 1024 * 1024; // bytes mapped per side at a time
+static constexpr qint64 CMP_BLOCK  = 64 * 1024;        // memcmp granularity inside a window
+
+namespace {
+
+// Sequential read-only view of a file, one window at a time. Windows are
+// memory-mapped when possible; otherwise they are read into a reusable buffer.
+class WindowReader {
+public:
+  explicit WindowReader(const QString& path) : m_file(path) {}
+  ~WindowReader() { release(); }
+
+  bool open() {
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+#ifdef AEQ_UNIX
+    ::posix_fadvise(m_file.handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    return true;
+  }
+  qint64 size() const { return m_file.size(); }
+  QString errorString() const { return m_file.errorString(); }
+
+  const uchar* window(qint64 off, qint64 len) {
+    release();
+    if (uchar* p = m_file.map(off, len)) {
+      m_mapped = p;
+#ifdef AEQ_UNIX
+      ::madvise(p, static_cast<size_t>(len), MADV_SEQUENTIAL); // off is window-aligned
+#endif
+      return p;
+    }
+    m_buf.resize(static_cast<size_t>(len));
+    if (!m_file.seek(off) || m_file.read(reinterpret_cast<char*>(m_buf.data()), len) != len) return nullptr;
+    return m_buf.data();
+  }
+
+private:
+  void release() { if (m_mapped) { m_file.unmap(m_mapped); m_mapped = nullptr; } }
+
+  QFile m_file;
+  uchar* m_mapped{nullptr};
+  std::vector<uchar> m_buf;
+};
+
+} // namespace
+
+static inline std::uint64_t loadWord(const uchar* p) { std::uint64_t w; std::memcpy(&w, p, sizeof w); return w; }
+
+// Offset (0-7) of the first byte in memory order that is non-zero in x; x != 0.
+static inline int firstNonZeroByte(std::uint64_t x) {
+#if defined(__GNUC__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+  return __builtin_ctzll(x) >> 3;
+#else
+  uchar b[sizeof x]; std::memcpy(b, &x, sizeof x);
+  int i = 0; while (!b[i]) ++i;
+  return i;
+#endif
+}
+
+// Offset (0-7) of the first byte in memory order that is zero in x, or 8 if none.
+static inline int firstZeroByte(std::uint64_t x) {
+#if defined(__GNUC__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+  // Classic has-zero-byte test; borrows only create false hits above a real zero.
+  const std::uint64_t z = (x - 0x0101010101010101ull) & ~x & 0x8080808080808080ull;
+  return z ? __builtin_ctzll(z) >> 3 : 8;
+#else
+  uchar b[sizeof x]; std::memcpy(b, &x, sizeof x);
+  int i = 0; while (i < 8 && b[i]) ++i;
+  return i;
+#endif
+}
+
+// First index in [i, n) where a and b differ, or n. Equal blocks go through memcmp;
+// only the block holding the mismatch is walked a word at a time.
+static qint64 findMismatch(const uchar* a, const uchar* b, qint64 i, qint64 n) {
+  while (i < n) {
+    const qint64 end = std::min(i + CMP_BLOCK, n);
+    if (std::memcmp(a + i, b + i, static_cast<size_t>(end - i)) == 0) { i = end; continue; }
+    for (; i + 8 <= end; i += 8) {
+      const std::uint64_t x = loadWord(a + i) ^ loadWord(b + i);
+      if (x) return i + firstNonZeroByte(x);
+    }
+    for (; i < end; ++i) if (a[i] != b[i]) return i;
+  }
+  return n;
+}
+
+// First index in [i, n) where a and b agree again, or n.
+static qint64 findMatch(const uchar* a, const uchar* b, qint64 i, qint64 n) {
+  for (; i + 8 <= n; i += 8) {
+    const int k = firstZeroByte(loadWord(a + i) ^ loadWord(b + i));
+    if (k < 8) return i + k;
+  }
+  for (; i < n; ++i) if (a[i] == b[i]) return i;
+  return n;
+}
+
+// Scan n bytes at absolute offset base; inRun carries an open range across calls.
+// Returns false once the first mismatch is found and ranges are not being counted.
+static bool scanDiffs(const uchar* a, const uchar* b, qint64 n, qint64 base, bool countRanges,
+                      ContentDiff& out, bool& inRun) {
+  qint64 i = 0;
+  while (i < n) {
+    if (inRun) {
+      i = findMatch(a, b, i, n);
+      if (i < n) inRun = false;
+      continue;
+    }
+    i = findMismatch(a, b, i, n);
+    if (i == n) break;
+    if (out.ranges == 0) out.firstDiff = static_cast<std::uint64_t>(base + i);
+    ++out.ranges;
+    inRun = true;
+    if (!countRanges) return false;
+  }
+  return true;
+}
+
+ContentDiff compareContents(const QString& src, const QString& dst, bool countRanges,
+                            const CancelFn& cancel, const ProgressFn& progress) {
+  ContentDiff out;
+  WindowReader rs(src), rd(dst);
+  if (!rs.open()) { out.error = QString("%1: %2").arg(src, rs.errorString()); return out; }
+  if (!rd.open()) { out.error = QString("%1: %2").arg(dst, rd.errorString()); return out; }
+
+  const qint64 ss = rs.size(), ds = rd.size();
+  const qint64 common = std::min(ss, ds);
+  const auto total = static_cast<std::uint64_t>(common);
+  bool inRun = false;
+  for (qint64 off = 0; off < common; off += CMP_WINDOW) {
+    if (cancel && cancel()) { out.error = "Cancelled"; return out; }
+    const qint64 len = std::min(CMP_WINDOW, common - off);
+    const uchar* a = rs.window(off, len);
+    if (!a) { out.error = QString("%1: %2").arg(src, rs.errorString()); return out; }
+    const uchar* b = rd.window(off, len);
+    if (!b) { out.error = QString("%1: %2").arg(dst, rd.errorString()); return out; }
+    const bool more = scanDiffs(a, b, len, off, countRanges, out, inRun);
+    if (progress) progress(static_cast<std::uint64_t>(off + len), total);
+    if (!more) { out.ok = true; return out; }
+  }
+
+  // Trailing bytes of the longer file form one range (joined to an open one).
+  if (ss != ds && !inRun) {
+    if (out.ranges == 0) out.firstDiff = static_cast<std::uint64_t>(common);
+    ++out.ranges;
+  }
+  out.ok = true;
+  out.identical = out.ranges == 0;
+  return out;
+}
+
 std::vector<DiffItem> compareDirs(const QString& srcRoot, const QString& dstRoot,
                                   const QSet<QString>& ignoreNames, const CancelFn& cancel) {
   auto srcFuture = QtConcurrent::run([&]{ return fastListFiles(srcRoot, ignoreNames, cancel); });
@@ -120,22 +302,34 @@ static bool ensureDirFor(const fs::path& p) {
   std::error_code ec; fs::create_directories(p.parent_path(), ec); return !ec;
 }
 
+bool copyItem(const QString& srcRoot, const QString& dstRoot, const QString& relpath, QString& error) {
+  std::filesystem::path sp = std::filesystem::u8path((srcRoot + "/" + relpath).toStdString());
+  std::filesystem::path dp = std::filesystem::u8path((dstRoot + "/" + relpath).toStdString());
+  std::error_code ec;
+  ensureDirFor(dp);
+  std::filesystem::copy_file(sp, dp, std::filesystem::copy_options::overwrite_existing, ec);
+  // Carry the source mtime over so the copy classifies as identical, not "destination newer".
+  if (!ec) {
+    const auto mtime = std::filesystem::last_write_time(sp, ec);
+    if (!ec) std::filesystem::last_write_time(dp, mtime, ec);
+  }
+  if (ec) { error = QString("%1: %2").arg(relpath, QString::fromStdString(ec.message())); return false; }
+  return true;
+}
+
 bool copyItems(const QString& srcRoot, const QString& dstRoot, const std::vector<DiffItem>& diffs,
-               int& copied, QStringList& errors, const CancelFn& cancel) {
-  copied = 0; errors.clear();
+               int& copied, QStringList& errors, MetaMap& touched, const CancelFn& cancel) {
+  copied = 0; errors.clear(); touched.clear();
   for (const auto& d : diffs) {
     if (cancel && cancel()) break;
     if (!(d.action == Action::CopyNew || d.action == Action::CopyNewer || d.action == Action::CopyMismatch))
       continue;
-    std::filesystem::path sp = std::filesystem::u8path((srcRoot + "/" + d.relpath).toStdString());
-    std::filesystem::path dp = std::filesystem::u8path((dstRoot + "/" + d.relpath).toStdString());
-    std::error_code ec;
-    ensureDirFor(dp);
-    std::filesystem::copy_file(sp, dp, std::filesystem::copy_options::overwrite_existing, ec);
-    if (ec) {
-      errors << QString("%1: %2").arg(d.relpath, QString::fromStdString(ec.message()));
-    } else {
+    QString err;
+    if (copyItem(srcRoot, dstRoot, d.relpath, err)) {
       ++copied;
+      touched.insert(d.relpath, statPath(dstRoot + "/" + d.relpath));
+    } else {
+      errors << err;
     }
   }
   return errors.isEmpty();
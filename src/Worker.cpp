@@ -2,14 +2,31 @@
 #include "Aequalis/Worker.hpp"
 #include "Aequalis/Scanner.hpp"
 #include <QtConcurrent>
+#include <QMutex>
+#include <QQueue>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <algorithm>
 
 namespace aequalis {
 
-CompareWorker::CompareWorker(bool filesMode, QString src, QString dst, QSet<QString> ignores, QObject* parent)
-  : QThread(parent), m_filesMode(filesMode), m_src(std::move(src)), m_dst(std::move(dst)), m_ignores(std::move(ignores)) {}
+CompareWorker::CompareWorker(bool filesMode, QString src, QString dst, QSet<QString> ignores, ContentCheck content, QObject* parent)
+  : QThread(parent), m_filesMode(filesMode), m_content(content),
+    m_src(std::move(src)), m_dst(std::move(dst)), m_ignores(std::move(ignores)) {}
 
 void CompareWorker::cancel() { m_cancel = true; }
 
+// Content verdict overrides the size/mtime heuristic: equal bytes are identical
+// whatever the timestamps say, and a metadata match with different bytes must copy.
+static void applyContentResult(DiffItem& di, const ContentDiff& cd, bool countedRanges) {
+  if (!cd.ok) { di.reason += QString(" (content check failed: %1)").arg(cd.error); return; }
+  if (cd.identical) { di.action = Action::Identical; di.reason = "Content identical"; return; }
+  auto where = QString("differs at byte %1").arg(cd.firstDiff);
+  if (countedRanges) where += QString(" (%1 range(s))").arg(cd.ranges);
+  if (di.action == Action::Identical) { di.action = Action::CopyMismatch; di.reason = "Content " + where; }
+  else di.reason += "; content " + where;
+}
+
 void CompareWorker::run() {
   try {
     if (m_filesMode) {
@@ -17,6 +34,17 @@ void CompareWorker::run() {
       emit progressRange(0, 1);
       auto di = compareFiles(m_src, m_dst);
       emit progressValue(1);
+      if (m_content != ContentCheck::Off && di.src.isFile && di.dst.isFile) {
+        const bool all = m_content == ContentCheck::AllRanges;
+        emit phase("Comparing contents…");
+        emit progressRange(0, 1000);
+        auto cd = compareContents(m_src, m_dst, all, [this]{ return m_cancel.load(); },
+                                  [this](std::uint64_t n, std::uint64_t total){
+                                    emit progressValue(total ? static_cast<int>(n * 1000 / total) : 1000);
+                                  });
+        if (m_cancel.load()) { emit cancelled(); return; }
+        applyContentResult(di, cd, all);
+      }
       emit done(std::vector<DiffItem>{std::move(di)});
       return;
     }
@@ -29,6 +57,7 @@ void CompareWorker::run() {
     auto dstFuture = QtConcurrent::run([&]{ return fastListFiles(m_dst, m_ignores, [this]{ return m_cancel.load(); }); });
     MetaMap sm = srcFuture.result();
     MetaMap dm = dstFuture.result();
+    if (m_cancel.load()) { emit cancelled(); return; }
 
     // Merge keys
     QSet<QString> keys;
@@ -56,6 +85,8 @@ void CompareWorker::run() {
       }
       ++i; emit progressValue(i);
     }
+    if (m_cancel.load()) { emit cancelled(); return; } // partial results would read as complete
+    std::sort(diffs.begin(), diffs.end(), relpathLess); // off the UI thread
 
     emit done(std::move(diffs));
   } catch (const std::exception& e) {
@@ -63,4 +94,149 @@ void CompareWorker::run() {
   }
 }
 
+static constexpr int SYNC_COPIERS = 4;      // concurrent copy tasks
+static constexpr int SYNC_QUEUE_CAP = 1024; // pending copies before the scan waits
+
+namespace {
+
+struct CopyJob {
+  size_t index;   // row in the sync result
+  QString relpath;
+};
+
+// Fixed-capacity hand-off from the scanning thread to the copy pool.
+class CopyQueue {
+public:
+  explicit CopyQueue(int capacity) : m_capacity(capacity) {}
+
+  void push(CopyJob job) { // blocks while full
+    QMutexLocker lock(&m_mutex);
+    while (m_jobs.size() >= m_capacity && !m_closed) m_notFull.wait(&m_mutex);
+    m_jobs.enqueue(std::move(job));
+    m_notEmpty.wakeOne();
+  }
+
+  bool pop(CopyJob& job) { // false once closed and drained
+    QMutexLocker lock(&m_mutex);
+    while (m_jobs.isEmpty() && !m_closed) m_notEmpty.wait(&m_mutex);
+    if (m_jobs.isEmpty()) return false;
+    job = m_jobs.dequeue();
+    m_notFull.wakeOne();
+    return true;
+  }
+
+  void close() {
+    QMutexLocker lock(&m_mutex);
+    m_closed = true;
+    m_notEmpty.wakeAll();
+    m_notFull.wakeAll();
+  }
+
+private:
+  QMutex m_mutex;
+  QWaitCondition m_notEmpty, m_notFull;
+  QQueue<CopyJob> m_jobs;
+  int m_capacity;
+  bool m_closed{false};
+};
+
+} // namespace
+
+SyncWorker::SyncWorker(QString src, QString dst, QSet<QString> ignores, QObject* parent)
+  : QThread(parent), m_src(std::move(src)), m_dst(std::move(dst)), m_ignores(std::move(ignores)) {}
+
+void SyncWorker::cancel() { m_cancel = true; }
+
+void SyncWorker::run() {
+  try {
+    emit phase("Syncing…");
+    emit progressRange(0, 0); // total unknown until the scan ends
+
+    const auto isCancelled = [this]{ return m_cancel.load(); };
+    // Names only: pairs are stat'd by the walk, destination-only files at the end.
+    auto dstFuture = QtConcurrent::run([&]{ return listFiles(m_dst, m_ignores, isCancelled); });
+
+    CopyQueue queue(SYNC_QUEUE_CAP);
+    QMutex resMutex;
+    std::vector<size_t> copiedRows;
+    QStringList errors;
+    std::atomic_int copied{0};
+    std::atomic_int processed{0}; // copy jobs finished, successful or not
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(SYNC_COPIERS);
+    std::vector<QFuture<void>> copiers;
+    for (int c = 0; c < SYNC_COPIERS; ++c) {
+      copiers.push_back(QtConcurrent::run(&pool, [&]{
+        CopyJob job;
+        while (queue.pop(job)) {
+          if (m_cancel.load()) continue; // keep draining so the scan never blocks
+          QString err;
+          const bool ok = copyItem(m_src, m_dst, job.relpath, err);
+          QMutexLocker lock(&resMutex);
+          if (ok) { copiedRows.push_back(job.index); ++copied; }
+          else errors << err;
+          emit progressValue(++processed); // ignored while the range is still open-ended
+        }
+      }));
+    }
+
+    // Walk the source; each file is classified against a direct stat of its
+    // destination twin, so copies can start before the destination scan ends.
+    std::vector<DiffItem> diffs;
+    int queued = 0;
+    try {
+      walkFiles(m_src, m_ignores, [&](const QString& r, const FileMeta& s){
+        auto di = classify(r, s, statPath(m_dst + "/" + r));
+        if (di.action == Action::CopyNew || di.action == Action::CopyNewer) {
+          queue.push(CopyJob{diffs.size(), r});
+          ++queued;
+        }
+        diffs.push_back(std::move(di));
+        if (diffs.size() % 256 == 0)
+          emit phase(QString("Syncing… scanned %1, copied %2").arg(diffs.size()).arg(copied.load()));
+      }, isCancelled);
+    } catch (...) {
+      m_cancel = true; queue.close(); pool.waitForDone(); dstFuture.waitForFinished();
+      throw;
+    }
+    queue.close();
+
+    // The walk fixed the number of copies; the bar now tracks the pool.
+    emit progressRange(0, queued);
+    emit progressValue(processed.load());
+    emit phase(QString("Finishing copies… scanned %1, copied %2").arg(diffs.size()).arg(copied.load()));
+    for (auto& f : copiers) f.waitForFinished();
+
+    // A cut-short walk cannot tell destination-only files from unvisited ones.
+    if (m_cancel.load()) {
+      dstFuture.waitForFinished();
+      emit cancelled(copied.load(), errors);
+      return;
+    }
+
+    // Copied rows now reflect the destination as written.
+    for (size_t row : copiedRows) {
+      auto& di = diffs[row];
+      di = classify(di.relpath, di.src, statPath(m_dst + "/" + di.relpath));
+    }
+
+    std::sort(diffs.begin(), diffs.end(), relpathLess); // off the UI thread
+    const auto srcEnd = diffs.end() - diffs.begin();
+    const QStringList dstNames = dstFuture.result();
+    for (const auto& r : dstNames) {
+      const auto it = std::lower_bound(diffs.begin(), diffs.begin() + srcEnd, r,
+                                       [](const DiffItem& d, const QString& k){ return d.relpath < k; });
+      if (it != diffs.begin() + srcEnd && it->relpath == r) continue;
+      diffs.push_back(DiffItem{r, Action::OnlyInDest, "Only in dest", FileMeta{}, statPath(m_dst + "/" + r)});
+    }
+    std::sort(diffs.begin() + srcEnd, diffs.end(), relpathLess);
+    std::inplace_merge(diffs.begin(), diffs.begin() + srcEnd, diffs.end(), relpathLess);
+
+    emit done(std::move(diffs), copied.load(), errors);
+  } catch (const std::exception& e) {
+    emit failed(QString::fromUtf8(e.what()));
+  }
+}
+
 } // namespace aequalis